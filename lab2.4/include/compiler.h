@@ -4,7 +4,8 @@
 #include <map>
 #include <vector>
 #include "message.h"
-#include "position.h"
+#include "line_index.h"
+#include "name_table.h"
 
 namespace lexer {
 
@@ -12,22 +13,23 @@ namespace lexer {
     public:
         Compiler() {
             messages = std::map<Position, Message>();
-            nameCodes = std::map<std::string, int>();
-            names = std::vector<std::string>();
         }
 
-        int AddName(const std::string &name);
+        uint32_t AddName(std::string_view name);
 
-        const std::string &GetName(int code);
+        std::string_view GetName(uint32_t code) const;
+
+        size_t NameCount() const;
 
         void AddMessage(Position pos, MessageType type, const std::string &text);
 
-        void OutputMessages();
+        void MergeMessages(const Compiler &other);
+
+        void OutputMessages(const LineIndex &lines);
 
     private:
         std::map <Position, Message> messages;
-        std::map<std::string, int> nameCodes;
-        std::vector <std::string> names;
+        NameTable names;
     };
 }
 
@@ -0,0 +1,52 @@
+#ifndef DFA_H
+#define DFA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lexer {
+
+    struct DfaRule {
+        std::string pattern;
+        bool icase;
+
+        DfaRule(std::string pattern, bool icase)
+        : pattern(std::move(pattern)), icase(icase) {}
+    };
+
+    // Maximal-munch DFA built from a list of regular expressions
+    // (literals, escapes, [classes], ( ), |, *, +, ?).
+    // On equal match length the rule with the smaller index wins.
+    class Dfa {
+    public:
+        static const int DeadState = 0;
+        static const int StartState = 1;
+
+        explicit Dfa(const std::vector<DfaRule> &rules);
+
+        int Next(int state, unsigned char c) const {
+            return transitions[state * classCount + classes[c]];
+        }
+
+        int Accept(int state) const {
+            return accepts[state];
+        }
+
+        size_t Match(const char *first, const char *last, int &rule) const;
+
+        size_t StateCount() const {
+            return accepts.size();
+        }
+
+    private:
+        std::array<uint8_t, 256> classes;
+        int classCount;
+        std::vector<int> transitions;
+        std::vector<int> accepts;
+    };
+}
+
+#endif
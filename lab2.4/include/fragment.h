@@ -12,12 +12,7 @@ namespace lexer {
 
         Fragment(const Position &starting, const Position &ending)
         : Starting(starting), Ending(ending) {}
-
-        friend std::ostream &operator<<(std::ostream &os, const Fragment &f) {
-            os << f.Starting << "-" << f.Ending;
-            return os;
-        };
     };
 }
 
-#endif
\ No newline at end of file
+#endif
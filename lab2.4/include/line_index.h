@@ -0,0 +1,33 @@
+#ifndef LINE_INDEX_H
+#define LINE_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fragment.h"
+
+namespace lexer {
+
+    // Maps byte offsets to 1-based (line, column) pairs. The table of line
+    // starts is built on first use; columns count UTF-8 code points.
+    class LineIndex {
+    public:
+        explicit LineIndex(std::string_view program)
+        : program(program) {}
+
+        uint64_t GetLine(const Position &p) const;
+        uint64_t GetPos(const Position &p) const;
+
+        std::string Format(const Position &p) const;
+        std::string Format(const Fragment &f) const;
+
+    private:
+        void Build() const;
+
+        std::string_view program;
+        mutable std::vector<uint64_t> starts;
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace lexer {
+
+    // Interns names into dense 32-bit codes. Lookup is an open-addressing
+    // hash table with linear probing; the characters are copied once into
+    // an arena of fixed-size blocks, so the views returned by GetName stay
+    // valid for the lifetime of the table.
+    class NameTable {
+    public:
+        NameTable();
+
+        NameTable(const NameTable &other) = delete;
+        NameTable &operator=(const NameTable &other) = delete;
+        NameTable(NameTable &&other) = default;
+        NameTable &operator=(NameTable &&other) = default;
+
+        uint32_t Add(std::string_view name);
+
+        std::string_view Get(uint32_t code) const {
+            return names[code];
+        }
+
+        size_t Size() const {
+            return names.size();
+        }
+
+    private:
+        struct Slot {
+            uint32_t hash;
+            uint32_t code;
+        };
+
+        static const uint32_t EmptySlot = UINT32_MAX;
+        static const size_t BlockSize = 64 * 1024;
+
+        std::string_view Store(std::string_view name);
+        void Grow();
+
+        std::vector<Slot> slots;
+        std::vector<std::string_view> names;
+        std::vector<std::unique_ptr<char[]>> blocks;
+        std::vector<std::unique_ptr<char[]>> large;
+        size_t block_used;
+    };
+}
+
+#endif
@@ -6,10 +6,13 @@
 #include "scanner.h"
 
 namespace parser {
+    // Interned name code, see lexer::Compiler::AddName.
+    using Symbol = uint32_t;
+
     class JsonNode {
     public:
         virtual ~JsonNode() = default;
-        virtual boost::json::value ToJson() const = 0;
+        virtual boost::json::value ToJson(const lexer::Compiler &compiler) const = 0;
     };
 
     class Expr : public JsonNode { };
@@ -19,48 +22,48 @@ namespace parser {
     public:
         int val;
         explicit ConstInt(int val) : val(val) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class ConstReal : public Expr {
     public:
         double val;
         explicit ConstReal(double val) : val(val) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class ConstString : public Expr {
     public:
         std::string val;
         explicit ConstString(std::string val) : val(std::move(val)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Var : public Expr {
     public:
-        std::string name;
+        Symbol name;
         std::string type;
-        Var(std::string name, std::string type)
-        : name(std::move(name)), type(std::move(type)) {}
-        boost::json::value ToJson() const override;
+        Var(Symbol name, std::string type)
+        : name(name), type(std::move(type)) {}
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class IndexedVar : public Expr {
     public:
-        std::string name;
+        Symbol name;
         ExprPtr index;
-        IndexedVar(std::string name, ExprPtr index)
-        : name(std::move(name)), index(std::move(index)) {}
-        boost::json::value ToJson() const override;
+        IndexedVar(Symbol name, ExprPtr index)
+        : name(name), index(std::move(index)) {}
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Call : public Expr {
     public:
-        std::string name;
+        Symbol name;
         std::vector<ExprPtr> args;
-        Call(std::string name, std::vector<ExprPtr>&& args)
-        : name(std::move(name)), args(std::move(args)) {}
-        boost::json::value ToJson() const override;
+        Call(Symbol name, std::vector<ExprPtr>&& args)
+        : name(name), args(std::move(args)) {}
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Unary : public Expr {
@@ -68,7 +71,7 @@ namespace parser {
         lexer::DomainTag op;
         ExprPtr operand;
         Unary(lexer::DomainTag op, ExprPtr expr) : op(op), operand(std::move(expr)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Binary : public Expr {
@@ -77,7 +80,7 @@ namespace parser {
         ExprPtr lhs, rhs;
         Binary(ExprPtr left, std::string op, ExprPtr right)
         : op(op), lhs(std::move(left)), rhs(std::move(right)){}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Stmt : public JsonNode { };
@@ -88,7 +91,7 @@ namespace parser {
         ExprPtr lhs, rhs;
         AssignStmt(ExprPtr left, ExprPtr right)
         : lhs(std::move(left)), rhs(std::move(right)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class IfStmt : public Stmt {
@@ -97,7 +100,7 @@ namespace parser {
         std::vector<StmtPtr> then_stmt, else_stmt;
         IfStmt(ExprPtr cond, std::vector<StmtPtr>&& then_stmt, std::vector<StmtPtr>&& else_stmt)
         : cond(std::move(cond)), then_stmt(std::move(then_stmt)), else_stmt(std::move(else_stmt)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class WhileStmt : public Stmt {
@@ -108,24 +111,24 @@ namespace parser {
         std::vector<StmtPtr> body;
         WhileStmt(bool pre_cond, bool until, ExprPtr cond, std::vector<StmtPtr>&& body)
         : pre_cond(pre_cond), until(until), cond(std::move(cond)), body(std::move(body)){}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class DimStmt : public Stmt {
     public:
         ExprPtr var;
         explicit DimStmt(ExprPtr var) : var(std::move(var)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class ForStmt : public Stmt {
     public:
-        std::string var;
+        Symbol var;
         ExprPtr from, to;
         std::vector<StmtPtr> body;
-        ForStmt(std::string var, ExprPtr from, ExprPtr to, std::vector<StmtPtr>&& body)
-        : var(std::move(var)), from(std::move(from)), to(std::move(to)), body(std::move(body)) {}
-        boost::json::value ToJson() const override;
+        ForStmt(Symbol var, ExprPtr from, ExprPtr to, std::vector<StmtPtr>&& body)
+        : var(var), from(std::move(from)), to(std::move(to)), body(std::move(body)) {}
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     struct Param {
@@ -135,13 +138,13 @@ namespace parser {
     class Function : public JsonNode {
     public:
         bool is_sub;
-        std::string name;
+        Symbol name;
         std::string return_type_mark;
         std::vector<ExprPtr> params;
         std::vector<StmtPtr> body;
-        Function(bool is_sub, std::string name, std::string type, std::vector<ExprPtr>&& params, std::vector<StmtPtr>&& body)
-        : is_sub(is_sub), name(std::move(name)), return_type_mark(std::move(type)), params(std::move(params)), body(std::move(body)) {}
-        boost::json::value ToJson() const override;
+        Function(bool is_sub, Symbol name, std::string type, std::vector<ExprPtr>&& params, std::vector<StmtPtr>&& body)
+        : is_sub(is_sub), name(name), return_type_mark(std::move(type)), params(std::move(params)), body(std::move(body)) {}
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 
     class Program : public JsonNode {
@@ -150,7 +153,7 @@ namespace parser {
         std::vector<StmtPtr> main_body;
         Program(std::vector<std::unique_ptr<Function>>&& funcs, std::vector<StmtPtr>&& body)
         : funcs(std::move(funcs)), main_body(std::move(body)) {}
-        boost::json::value ToJson() const override;
+        boost::json::value ToJson(const lexer::Compiler &compiler) const override;
     };
 }
 
@@ -2,12 +2,20 @@
 #define PARSER_H
 
 #include "node.h"
+#include "token_pipeline.h"
 
 namespace parser {
+    struct ParseOptions {
+        // Tokenize the whole input in parallel chunks on this pool first.
+        util::ThreadPool *pool = nullptr;
+        // Run the scanner on its own thread, overlapping with parsing.
+        bool pipelined = false;
+    };
+
     class Parser final {
     public:
-        Parser(std::unique_ptr<lexer::Scanner>&& scanner)
-        : scanner(std::move(scanner)) {}
+        Parser(std::unique_ptr<lexer::Scanner>&& scanner, ParseOptions options = ParseOptions())
+        : scanner(std::move(scanner)), options(options), tokens(std::string_view()) {}
 
         Parser(const Parser& other) = delete;
         Parser& operator=(const Parser& other) = delete;
@@ -32,18 +40,20 @@ namespace parser {
         std::unique_ptr<parser::Expr> Factor();
         std::unique_ptr<parser::Expr> Const();
 
-        template <typename T>
-        std::unique_ptr<T> ExpectAndCast(const lexer::DomainTag tag);
+        lexer::TokenRecord ExpectAndTake(const lexer::DomainTag tag);
 
         void Expect(const lexer::DomainTag tag);
 
-        template <typename T>
-        std::unique_ptr<T> SymTo();
+        void Advance();
 
         [[noreturn]] void ThrowParseError(std::vector<lexer::DomainTag>&& expected);
 
         std::unique_ptr<lexer::Scanner> scanner;
-        std::unique_ptr<lexer::Token> sym;
+        ParseOptions options;
+        std::unique_ptr<lexer::TokenPipeline> pipeline;
+        lexer::TokenStream tokens;
+        size_t index = 0;
+        const lexer::TokenRecord *sym = nullptr;
     };
 
 }
@@ -1,65 +1,39 @@
 #ifndef POSITION_H
 #define POSITION_H
 
-#include <string>
-#include <ostream>
+#include <cstdint>
 
 namespace lexer {
 
+    // Byte offset into the program text. Line and column are derived on
+    // demand through LineIndex.
     class Position {
     public:
-        explicit Position(std::string *program)
-        : line(1), pos(1), index(0), program(program) {}
+        Position() : index(0) {}
+
+        explicit Position(uint64_t index) : index(index) {}
 
         bool operator<(const Position &other) const {
             return index < other.index;
         }
 
-        friend std::ostream &operator<<(std::ostream &os, const Position &p) {
-            os << "(" << p.line << ", " << p.pos << ")";
-            return os;
-        };
-
-        bool IsNewLine();
-        bool EndOfProgram();
-
         Position& operator++(int) {
-            if (index < program->size()) {
-                auto c = static_cast<unsigned char>((*program)[index]);
-                if (IsNewLine()) {
-                    if (c == '\r') {
-                        index++;
-                    }
-                    line++;
-                    pos = 1;
-                } else if ((c & 0xC0) != 0x80) {
-                    pos++;
-                }
-                index++;
-            }
+            index++;
             return *this;
         }
 
-        Position& operator+=(size_t k) {
-            for (size_t i = 0; i < k; i++) {
-                this->operator++(1);
-            }
+        Position& operator+=(uint64_t k) {
+            index += k;
             return *this;
         }
 
-        int GetLine() const;
-        int GetPos() const;
-        int GetIndex() const;
-        void AdvanceLine();
-        void AdvancePos();
-        void AdvanceIndex();
-        void PosDefault();
+        uint64_t GetIndex() const {
+            return index;
+        }
+
     private:
-        int line;
-        int pos;
-        int index;
-        std::string *program;
+        uint64_t index;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
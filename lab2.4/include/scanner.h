@@ -4,28 +4,55 @@
 #include <memory>
 #include <iostream>
 #include "token.h"
+#include "token_stream.h"
 #include "compiler.h"
+#include "thread_pool.h"
 
 namespace lexer {
 
     class Scanner {
     public:
-        Scanner(const std::string &text, Compiler *compiler)
-        : program(text), compiler(compiler), cur(&program) {}
+        // text must outlive the scanner and every token it returns:
+        // token payloads are views into it.
+        Scanner(std::string_view text, Compiler *compiler)
+        : program(text), compiler(compiler), lines(text), limit(text.size()) {}
+
+        Scanner(const Scanner &other) = delete;
+        Scanner &operator=(const Scanner &other) = delete;
 
         std::unique_ptr <Token> NextToken();
 
+        TokenStream Tokenize();
+
+        // Appends up to max_tokens tokens; returns true once EndOfProgram
+        // has been appended.
+        bool TokenizeBatch(TokenStream &tokens, size_t max_tokens);
+
+        TokenStream Tokenize(util::ThreadPool &pool, size_t chunk_size = 1 << 20);
+
+        std::string_view Text() const {
+            return program;
+        }
+
+        const LineIndex &Lines() const {
+            return lines;
+        }
+
         void OutputComments() {
             for (auto comment : comments) {
-                std::cout << comment << std::endl;
+                std::cout << lines.Format(comment) << std::endl;
             }
         }
 
     private:
-        std::string program;
+        DomainTag NextLexeme(Position &start);
+
+        std::string_view program;
         Compiler *compiler;
         std::vector <Fragment> comments;
+        LineIndex lines;
         Position cur;
+        uint64_t limit;
     };
 
 }
@@ -0,0 +1,25 @@
+#ifndef SKIP_H
+#define SKIP_H
+
+#include <cstddef>
+
+namespace lexer {
+
+    // Vectorized run scanners used by the scanner for the most frequent
+    // lexemes. Each returns the first index in [from, size) that ends the
+    // run, or size. The implementation (AVX2, SSE2 or scalar) is chosen
+    // once at startup from the CPU features.
+
+    // [ \t\n\r]*
+    size_t SkipWhiteSpace(const char *text, size_t from, size_t size);
+
+    // [^\n]*
+    size_t SkipLine(const char *text, size_t from, size_t size);
+
+    // [A-Za-z0-9]*
+    size_t SkipIdent(const char *text, size_t from, size_t size);
+
+    const char *SkipImplementation();
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H
+
+#include <string>
+#include <string_view>
+
+namespace lexer {
+
+    // Read-only memory mapping of a program file.
+    class SourceFile {
+    public:
+        explicit SourceFile(const std::string &path);
+        ~SourceFile();
+
+        SourceFile(const SourceFile &other) = delete;
+        SourceFile &operator=(const SourceFile &other) = delete;
+
+        std::string_view Text() const {
+            return std::string_view(data, size);
+        }
+
+    private:
+        const char *data;
+        size_t size;
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace util {
+
+    // Lock-free bounded queue for exactly one producer and one consumer thread.
+    template <typename T, size_t Capacity>
+    class SpscRing {
+    public:
+        bool TryPush(T &&value) {
+            size_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) == Capacity) {
+                return false;
+            }
+            slots[t % Capacity] = std::move(value);
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T &value) {
+            size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = std::move(slots[h % Capacity]);
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<T, Capacity> slots;
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+    };
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+    // Fixed-size pool of worker threads executing submitted tasks in FIFO order.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threads) {
+            if (threads == 0) {
+                threads = 1;
+            }
+            for (size_t i = 0; i < threads; i++) {
+                workers.emplace_back([this] { Work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &other) = delete;
+        ThreadPool &operator=(const ThreadPool &other) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_all();
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        }
+
+        template <typename F>
+        auto Submit(F &&f) -> std::future<decltype(f())> {
+            auto task = std::make_shared<std::packaged_task<decltype(f())()>>(std::forward<F>(f));
+            auto result = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.emplace([task] { (*task)(); });
+            }
+            ready.notify_one();
+            return result;
+        }
+
+        size_t Size() const {
+            return workers.size();
+        }
+
+    private:
+        void Work() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+                    if (tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(tasks.front());
+                    tasks.pop();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable ready;
+        bool stopping = false;
+    };
+}
+
+#endif
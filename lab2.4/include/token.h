@@ -1,11 +1,13 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <cstdint>
+#include <string_view>
 #include "fragment.h"
 
 namespace lexer {
 
-    enum class DomainTag {
+    enum class DomainTag : uint8_t {
         LeftParen,
         RightParen,
         LeftBracket,
@@ -96,14 +98,14 @@ namespace lexer {
 
     class IdentToken : public Token {
     public:
-        IdentToken(const std::string &val, const Position &starting, const Position &following)
+        IdentToken(std::string_view val, const Position &starting, const Position &following)
         : val(val), Token(DomainTag::Ident, starting, following) {}
 
-        const std::string &GetVal() {
+        std::string_view GetVal() const {
             return val;
         }
     private:
-        std::string val;
+        std::string_view val;
     };
 
     class KeywordToken : public Token {
@@ -138,26 +140,26 @@ namespace lexer {
 
     class StringConstToken : public Token {
     public:
-        StringConstToken(const std::string &val, const Position &starting, const Position &following)
+        StringConstToken(std::string_view val, const Position &starting, const Position &following)
         : val(val), Token(DomainTag::StringConst, starting, following) {}
 
-        const std::string &GetVal() {
+        std::string_view GetVal() const {
             return val;
         }
     private:
-        std::string val;
+        std::string_view val;
     };
 
     class SpecToken : public Token {
     public:
-        SpecToken(DomainTag tag, const std::string &val, const Position &starting, const Position &following)
+        SpecToken(DomainTag tag, std::string_view val, const Position &starting, const Position &following)
         : val(val), Token(tag, starting, following) {}
 
-        const std::string &GetVal() {
+        std::string_view GetVal() const {
             return val;
         }
     private:
-        std::string val;
+        std::string_view val;
     };
 
     class EOFToken : public Token {
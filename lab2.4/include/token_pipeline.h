@@ -0,0 +1,46 @@
+#ifndef TOKEN_PIPELINE_H
+#define TOKEN_PIPELINE_H
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include "scanner.h"
+#include "spsc_ring.h"
+
+namespace lexer {
+
+    // Runs a Scanner on its own thread and hands its tokens to the consumer
+    // in batches through a lock-free ring.
+    class TokenPipeline {
+    public:
+        explicit TokenPipeline(Scanner *scanner, size_t batch_size = 4096);
+        ~TokenPipeline();
+
+        TokenPipeline(const TokenPipeline &other) = delete;
+        TokenPipeline &operator=(const TokenPipeline &other) = delete;
+
+        // Blocks until the next batch is ready. A lexer exception is
+        // rethrown after the tokens that precede it have been handed out.
+        TokenStream Next();
+
+    private:
+        struct Batch {
+            TokenStream tokens;
+            std::exception_ptr error;
+
+            explicit Batch(std::string_view program) : tokens(program) {}
+        };
+
+        void Produce();
+
+        Scanner *scanner;
+        size_t batch_size;
+        util::SpscRing<std::unique_ptr<Batch>, 64> ring;
+        std::exception_ptr pending;
+        std::atomic<bool> cancelled{false};
+        std::thread producer;
+    };
+}
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "token.h"
+
+namespace lexer {
+
+    // Fixed-size token record. StringConst and Spec payloads are the source
+    // slice [start, start + length); Ident keeps its interned name code and
+    // IntConst and RealConst an index into the literal side tables.
+    struct TokenRecord {
+        uint64_t start;
+        uint32_t length;
+        uint32_t payload;
+        DomainTag tag;
+    };
+
+    class TokenStream {
+    public:
+        explicit TokenStream(std::string_view program)
+        : program(program) {}
+
+        void Push(DomainTag tag, uint64_t start, uint64_t end, uint32_t payload) {
+            records.push_back({start, static_cast<uint32_t>(end - start), payload, tag});
+        }
+
+        uint32_t AddInt(int val) {
+            ints.push_back(val);
+            return static_cast<uint32_t>(ints.size() - 1);
+        }
+
+        uint32_t AddReal(double val) {
+            reals.push_back(val);
+            return static_cast<uint32_t>(reals.size() - 1);
+        }
+
+        // Appends the tokens of another stream over the same program,
+        // without its EndOfProgram token. names maps the name codes of the
+        // other stream to codes of this one.
+        void Append(const TokenStream &other, const std::vector<uint32_t> &names) {
+            for (auto t: other.records) {
+                if (t.tag == DomainTag::EndOfProgram) {
+                    continue;
+                }
+                if (t.tag == DomainTag::Ident) {
+                    t.payload = names[t.payload];
+                } else if (t.tag == DomainTag::IntConst) {
+                    t.payload += static_cast<uint32_t>(ints.size());
+                } else if (t.tag == DomainTag::RealConst) {
+                    t.payload += static_cast<uint32_t>(reals.size());
+                }
+                records.push_back(t);
+            }
+            ints.insert(ints.end(), other.ints.begin(), other.ints.end());
+            reals.insert(reals.end(), other.reals.begin(), other.reals.end());
+        }
+
+        const TokenRecord &operator[](size_t i) const {
+            return records[i];
+        }
+
+        size_t Size() const {
+            return records.size();
+        }
+
+        std::string_view Text(const TokenRecord &t) const {
+            return program.substr(t.start, t.length);
+        }
+
+        uint32_t Name(const TokenRecord &t) const {
+            return t.payload;
+        }
+
+        int Int(const TokenRecord &t) const {
+            return ints[t.payload];
+        }
+
+        double Real(const TokenRecord &t) const {
+            return reals[t.payload];
+        }
+
+        Fragment Coords(const TokenRecord &t) const {
+            return Fragment(Position(t.start), Position(t.start + t.length));
+        }
+
+    private:
+        std::string_view program;
+        std::vector<TokenRecord> records;
+        std::vector<int> ints;
+        std::vector<double> reals;
+    };
+}
+
+#endif
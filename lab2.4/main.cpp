@@ -1,27 +1,47 @@
 #include <fstream>
 
 #include "include/parser.h"
+#include "include/source_file.h"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
+    size_t jobs = 0;
+    bool pipelined = false;
+    while (argc > 3 && argv[1][0] == '-') {
+        if (string(argv[1]) == "-j") {
+            jobs = stoul(argv[2]);
+            argc--;
+            argv++;
+        } else if (string(argv[1]) == "-p") {
+            pipelined = true;
+        } else {
+            break;
+        }
+        argc--;
+        argv++;
+    }
     if (argc != 3) {
-        std::cerr << "Whoops: needed program.txt\n";
+        std::cerr << "Whoops: needed [-j jobs] [-p] program.txt ast.json\n";
         return 1;
     }
-    ifstream file(argv[1]);
-    string programText((istreambuf_iterator<char>(file)),
-                       (istreambuf_iterator<char>()));
-    file.close();
-
-    lexer::Compiler compiler;
-    unique_ptr<lexer::Scanner> scanner = make_unique<lexer::Scanner>(programText, &compiler);
-    parser::Parser parser(std::move(scanner));
 
     try {
+        lexer::SourceFile source(argv[1]);
+        lexer::Compiler compiler;
+        parser::ParseOptions options;
+        unique_ptr<util::ThreadPool> pool;
+        if (jobs > 1) {
+            pool = make_unique<util::ThreadPool>(jobs);
+            options.pool = pool.get();
+        }
+        options.pipelined = pipelined;
+        unique_ptr<lexer::Scanner> scanner = make_unique<lexer::Scanner>(source.Text(), &compiler);
+        parser::Parser parser(std::move(scanner), options);
+
         const unique_ptr<parser::Program> root = parser.RecursiveDescentParse();
         std::ofstream out(argv[2]);
-        out << boost::json::serialize(root->ToJson());
+        out << boost::json::serialize(root->ToJson(compiler));
         cout << "Saved AST tree..." << endl;
     } catch (const std::exception& e) {
         cerr << e.what() << endl;
@@ -29,4 +49,4 @@ int main(int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -4,29 +4,31 @@
 
 namespace lexer {
 
-    int Compiler::AddName(const std::string &name) {
-        auto nameCode = nameCodes.find(name);
-        if (nameCode != nameCodes.end()) {
-            return nameCode->second;
-        } else {
-            int code = (int) names.size();
-            names.push_back(name);
-            nameCodes[name] = code;
-            return code;
-        }
+    uint32_t Compiler::AddName(std::string_view name) {
+        return names.Add(name);
+    }
+
+    std::string_view Compiler::GetName(uint32_t code) const {
+        return names.Get(code);
     }
 
-    const std::string &Compiler::GetName(int code) {
-        return names[code];
+    size_t Compiler::NameCount() const {
+        return names.Size();
     }
 
     void Compiler::AddMessage(Position pos, MessageType type, const std::string &text) {
         messages[pos] = Message(type, text);
     }
 
-    void Compiler::OutputMessages() {
+    void Compiler::MergeMessages(const Compiler &other) {
+        for (const auto &message: other.messages) {
+            messages[message.first] = message.second;
+        }
+    }
+
+    void Compiler::OutputMessages(const LineIndex &lines) {
         for (const auto &message: messages) {
-            std::cout << message.first << ": " << message.second << std::endl;
+            std::cout << lines.Format(message.first) << ": " << message.second << std::endl;
         }
     }
 
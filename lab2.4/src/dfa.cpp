@@ -0,0 +1,280 @@
+#include "include/dfa.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+namespace lexer {
+
+    namespace {
+
+        struct NfaState {
+            std::bitset<256> chars;
+            int next = -1;
+            std::vector<int> eps;
+            int accept = -1;
+        };
+
+        struct NfaFragment {
+            int start;
+            int end;
+        };
+
+        class RegexParser {
+        public:
+            RegexParser(const DfaRule &rule, std::vector<NfaState> &nfa)
+            : pattern(rule.pattern), icase(rule.icase), nfa(nfa) {}
+
+            NfaFragment Parse() {
+                auto frag = Alt();
+                if (index != pattern.size()) {
+                    Fail("unexpected ')'");
+                }
+                return frag;
+            }
+
+        private:
+            // Alt ::= Seq ('|' Seq)*
+            NfaFragment Alt() {
+                auto frag = Seq();
+                while (Peek('|')) {
+                    index++;
+                    auto rhs = Seq();
+                    int start = NewState(), end = NewState();
+                    nfa[start].eps = {frag.start, rhs.start};
+                    nfa[frag.end].eps.push_back(end);
+                    nfa[rhs.end].eps.push_back(end);
+                    frag = {start, end};
+                }
+                return frag;
+            }
+
+            // Seq ::= Postfix*
+            NfaFragment Seq() {
+                int start = NewState();
+                NfaFragment frag = {start, start};
+                while (index < pattern.size() && !Peek('|') && !Peek(')')) {
+                    auto next = Postfix();
+                    nfa[frag.end].eps.push_back(next.start);
+                    frag.end = next.end;
+                }
+                return frag;
+            }
+
+            // Postfix ::= Atom ('*' | '+' | '?')*
+            NfaFragment Postfix() {
+                auto frag = Atom();
+                while (Peek('*') || Peek('+') || Peek('?')) {
+                    char op = pattern[index++];
+                    int start = NewState(), end = NewState();
+                    nfa[start].eps.push_back(frag.start);
+                    nfa[frag.end].eps.push_back(end);
+                    if (op != '+') {
+                        nfa[start].eps.push_back(end);
+                    }
+                    if (op != '?') {
+                        nfa[frag.end].eps.push_back(frag.start);
+                    }
+                    frag = {start, end};
+                }
+                return frag;
+            }
+
+            // Atom ::= '(' Alt ')' | '[' Class ']' | '.' | CHAR
+            NfaFragment Atom() {
+                std::bitset<256> chars;
+                if (Peek('(')) {
+                    index++;
+                    auto frag = Alt();
+                    if (!Peek(')')) {
+                        Fail("expected ')'");
+                    }
+                    index++;
+                    return frag;
+                } else if (Peek('[')) {
+                    index++;
+                    chars = Class();
+                } else if (Peek('.')) {
+                    index++;
+                    chars.set();
+                    chars.reset('\n');
+                } else {
+                    AddChar(chars, Char());
+                }
+                int start = NewState(), end = NewState();
+                nfa[start].chars = chars;
+                nfa[start].next = end;
+                return {start, end};
+            }
+
+            // Class ::= '^'? (CHAR ('-' CHAR)?)*
+            std::bitset<256> Class() {
+                std::bitset<256> chars;
+                bool negate = Peek('^');
+                if (negate) {
+                    index++;
+                }
+                while (!Peek(']')) {
+                    if (index == pattern.size()) {
+                        Fail("expected ']'");
+                    }
+                    unsigned char from = Char();
+                    unsigned char to = from;
+                    if (Peek('-') && index + 1 < pattern.size() && pattern[index + 1] != ']') {
+                        index++;
+                        to = Char();
+                    }
+                    for (int c = from; c <= to; c++) {
+                        AddChar(chars, static_cast<unsigned char>(c));
+                    }
+                }
+                index++;
+                if (negate) {
+                    chars.flip();
+                }
+                return chars;
+            }
+
+            unsigned char Char() {
+                if (index == pattern.size()) {
+                    Fail("unexpected end of pattern");
+                }
+                char c = pattern[index++];
+                if (c != '\\') {
+                    return c;
+                }
+                if (index == pattern.size()) {
+                    Fail("dangling '\\'");
+                }
+                c = pattern[index++];
+                switch (c) {
+                    case 'n': return '\n';
+                    case 'r': return '\r';
+                    case 't': return '\t';
+                    default: return c;
+                }
+            }
+
+            void AddChar(std::bitset<256> &chars, unsigned char c) const {
+                chars.set(c);
+                if (icase && std::isalpha(c)) {
+                    chars.set(std::tolower(c));
+                    chars.set(std::toupper(c));
+                }
+            }
+
+            bool Peek(char c) const {
+                return index < pattern.size() && pattern[index] == c;
+            }
+
+            int NewState() {
+                nfa.emplace_back();
+                return static_cast<int>(nfa.size()) - 1;
+            }
+
+            [[noreturn]] void Fail(const std::string &what) const {
+                throw std::runtime_error("bad token pattern \"" + pattern + "\": " + what);
+            }
+
+            const std::string &pattern;
+            bool icase;
+            std::vector<NfaState> &nfa;
+            size_t index = 0;
+        };
+
+        void Closure(const std::vector<NfaState> &nfa, std::vector<int> &states) {
+            std::vector<bool> seen(nfa.size());
+            std::vector<int> stack = states;
+            for (int s : states) {
+                seen[s] = true;
+            }
+            while (!stack.empty()) {
+                int s = stack.back();
+                stack.pop_back();
+                for (int t : nfa[s].eps) {
+                    if (!seen[t]) {
+                        seen[t] = true;
+                        states.push_back(t);
+                        stack.push_back(t);
+                    }
+                }
+            }
+            std::sort(states.begin(), states.end());
+        }
+    }
+
+    Dfa::Dfa(const std::vector<DfaRule> &rules) {
+        std::vector<NfaState> nfa(1);
+        for (size_t i = 0; i < rules.size(); i++) {
+            auto frag = RegexParser(rules[i], nfa).Parse();
+            nfa[0].eps.push_back(frag.start);
+            nfa[frag.end].accept = static_cast<int>(i);
+        }
+
+        std::map<std::vector<bool>, int> signatures;
+        std::vector<unsigned char> representatives;
+        for (int c = 0; c < 256; c++) {
+            std::vector<bool> signature;
+            for (auto &state : nfa) {
+                if (state.next >= 0) {
+                    signature.push_back(state.chars.test(c));
+                }
+            }
+            auto it = signatures.emplace(signature, static_cast<int>(signatures.size())).first;
+            if (it->second == static_cast<int>(representatives.size())) {
+                representatives.push_back(static_cast<unsigned char>(c));
+            }
+            classes[c] = static_cast<uint8_t>(it->second);
+        }
+        classCount = static_cast<int>(representatives.size());
+
+        std::vector<std::vector<int>> sets = {{}, {0}};
+        Closure(nfa, sets[StartState]);
+        std::map<std::vector<int>, int> ids = {{sets[DeadState], DeadState}, {sets[StartState], StartState}};
+
+        for (size_t id = 0; id < sets.size(); id++) {
+            int accept = -1;
+            for (int s : sets[id]) {
+                if (nfa[s].accept >= 0 && (accept < 0 || nfa[s].accept < accept)) {
+                    accept = nfa[s].accept;
+                }
+            }
+            accepts.push_back(accept);
+
+            for (unsigned char c : representatives) {
+                std::vector<int> target;
+                for (int s : sets[id]) {
+                    if (nfa[s].next >= 0 && nfa[s].chars.test(c)) {
+                        target.push_back(nfa[s].next);
+                    }
+                }
+                Closure(nfa, target);
+                auto it = ids.find(target);
+                if (it == ids.end()) {
+                    it = ids.emplace(target, static_cast<int>(sets.size())).first;
+                    sets.push_back(target);
+                }
+                transitions.push_back(it->second);
+            }
+        }
+    }
+
+    size_t Dfa::Match(const char *first, const char *last, int &rule) const {
+        int state = StartState;
+        size_t len = 0;
+        rule = -1;
+        for (const char *p = first; p != last; p++) {
+            state = Next(state, static_cast<unsigned char>(*p));
+            if (state == DeadState) {
+                break;
+            }
+            if (accepts[state] >= 0) {
+                rule = accepts[state];
+                len = p - first + 1;
+            }
+        }
+        return len;
+    }
+}
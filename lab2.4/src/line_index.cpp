@@ -0,0 +1,58 @@
+#include "include/line_index.h"
+
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lexer {
+
+    void LineIndex::Build() const {
+        const char *text = program.data();
+        size_t size = program.size();
+        size_t i = 0;
+        starts.push_back(0);
+#if defined(__SSE2__)
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; i + 16 <= size; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+            unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+            while (mask != 0) {
+                starts.push_back(i + __builtin_ctz(mask) + 1);
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; i < size; i++) {
+            if (text[i] == '\n') {
+                starts.push_back(i + 1);
+            }
+        }
+    }
+
+    uint64_t LineIndex::GetLine(const Position &p) const {
+        if (starts.empty()) {
+            Build();
+        }
+        return std::upper_bound(starts.begin(), starts.end(), p.GetIndex()) - starts.begin();
+    }
+
+    uint64_t LineIndex::GetPos(const Position &p) const {
+        uint64_t line_start = starts[GetLine(p) - 1];
+        uint64_t pos = 1;
+        for (uint64_t i = line_start; i < p.GetIndex(); i++) {
+            if ((static_cast<unsigned char>(program[i]) & 0xC0) != 0x80) {
+                pos++;
+            }
+        }
+        return pos;
+    }
+
+    std::string LineIndex::Format(const Position &p) const {
+        return "(" + std::to_string(GetLine(p)) + ", " + std::to_string(GetPos(p)) + ")";
+    }
+
+    std::string LineIndex::Format(const Fragment &f) const {
+        return Format(f.Starting) + "-" + Format(f.Ending);
+    }
+}
@@ -0,0 +1,71 @@
+#include "include/name_table.h"
+
+#include <cstring>
+
+namespace lexer {
+
+    namespace {
+        uint32_t Hash(std::string_view name) {
+            uint32_t h = 2166136261u;
+            for (char c: name) {
+                h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            return h;
+        }
+    }
+
+    NameTable::NameTable()
+    : slots(64, Slot{0, EmptySlot}), block_used(BlockSize) {}
+
+    uint32_t NameTable::Add(std::string_view name) {
+        uint32_t hash = Hash(name);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            Slot &slot = slots[i];
+            if (slot.code == EmptySlot) {
+                slot.hash = hash;
+                slot.code = static_cast<uint32_t>(names.size());
+                names.push_back(Store(name));
+                if (names.size() * 2 > slots.size()) {
+                    Grow();
+                }
+                return static_cast<uint32_t>(names.size() - 1);
+            }
+            if (slot.hash == hash && names[slot.code] == name) {
+                return slot.code;
+            }
+        }
+    }
+
+    std::string_view NameTable::Store(std::string_view name) {
+        if (name.size() > BlockSize / 4) {
+            large.emplace_back(new char[name.size()]);
+            std::memcpy(large.back().get(), name.data(), name.size());
+            return std::string_view(large.back().get(), name.size());
+        }
+        if (block_used + name.size() > BlockSize) {
+            blocks.emplace_back(new char[BlockSize]);
+            block_used = 0;
+        }
+        char *dst = blocks.back().get() + block_used;
+        std::memcpy(dst, name.data(), name.size());
+        block_used += name.size();
+        return std::string_view(dst, name.size());
+    }
+
+    void NameTable::Grow() {
+        std::vector<Slot> old(slots.size() * 2, Slot{0, EmptySlot});
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const Slot &slot: old) {
+            if (slot.code == EmptySlot) {
+                continue;
+            }
+            size_t i = slot.hash & mask;
+            while (slots[i].code != EmptySlot) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        }
+    }
+}
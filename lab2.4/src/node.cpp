@@ -6,143 +6,143 @@ using boost::json::object;
 using boost::json::array;
 
 namespace parser {
-    value ConstInt::ToJson() const {
+    value ConstInt::ToJson(const lexer::Compiler &compiler) const {
         return {
             {"kind", "int"},
             {"value", value(val)}
         };
     }
 
-    value ConstReal::ToJson() const {
+    value ConstReal::ToJson(const lexer::Compiler &compiler) const {
         return {
                 {"kind", "real"},
                 {"value", value(val)}
         };
     }
 
-    value ConstString::ToJson() const {
+    value ConstString::ToJson(const lexer::Compiler &compiler) const {
         return {
                 {"kind", "string"},
                 {"value", value(val)}
         };
     }
 
-    value Var::ToJson() const {
+    value Var::ToJson(const lexer::Compiler &compiler) const {
         return {
                 {"kind", "var"},
-                {"name", value(name), {"type", value(type)}}
+                {"name", value(compiler.GetName(name)), {"type", value(type)}}
         };
     }
 
-    value IndexedVar::ToJson() const {
+    value IndexedVar::ToJson(const lexer::Compiler &compiler) const {
         return {
             {"kind", "index"},
-            {"name", name}, {"index", index->ToJson()}
+            {"name", compiler.GetName(name)}, {"index", index->ToJson(compiler)}
         };
     }
 
-    value Call::ToJson() const {
+    value Call::ToJson(const lexer::Compiler &compiler) const {
         array args_arr;
         for (auto& arg : args) {
-            args_arr.emplace_back(arg->ToJson());
+            args_arr.emplace_back(arg->ToJson(compiler));
         }
 
         return {
                 {"kind", "call"},
-                {"name", name},
+                {"name", compiler.GetName(name)},
                 {"args", std::move(args_arr)}
         };
     }
 
-    value Unary::ToJson() const {
+    value Unary::ToJson(const lexer::Compiler &compiler) const {
         return {
             {"kind", "unary"},
-            {"op", lexer::ToString(op)}, {"arg", operand->ToJson()}
+            {"op", lexer::ToString(op)}, {"arg", operand->ToJson(compiler)}
         };
     }
 
-    value Binary::ToJson() const {
+    value Binary::ToJson(const lexer::Compiler &compiler) const {
         return {
             {"kind", "binary"}, {"op", op},
-            {"lhs", lhs->ToJson()}, {"rhs", rhs->ToJson()}
+            {"lhs", lhs->ToJson(compiler)}, {"rhs", rhs->ToJson(compiler)}
         };
     }
 
-    value AssignStmt::ToJson() const {
+    value AssignStmt::ToJson(const lexer::Compiler &compiler) const {
         return {
-            {"kind", "assign"}, {"lhs", lhs->ToJson()}, {"rhs", rhs->ToJson()}
+            {"kind", "assign"}, {"lhs", lhs->ToJson(compiler)}, {"rhs", rhs->ToJson(compiler)}
         };
     }
 
-    value IfStmt::ToJson() const {
+    value IfStmt::ToJson(const lexer::Compiler &compiler) const {
         array then_args;
         for (auto& st: then_stmt) {
-            then_args.emplace_back(st->ToJson());
+            then_args.emplace_back(st->ToJson(compiler));
         }
         array else_args;
         for (auto& st: else_stmt) {
-            else_args.emplace_back(st->ToJson());
+            else_args.emplace_back(st->ToJson(compiler));
         }
         return {
-            {"kind", "if"}, {"cond", cond->ToJson()},
+            {"kind", "if"}, {"cond", cond->ToJson(compiler)},
             {"then", std::move(then_args)}, {"else", std::move(else_args)}
         };
     }
 
-    value WhileStmt::ToJson() const {
+    value WhileStmt::ToJson(const lexer::Compiler &compiler) const {
         array body_args;
         for (auto& st: body) {
-            body_args.emplace_back(st->ToJson());
+            body_args.emplace_back(st->ToJson(compiler));
         }
 
         return {
             {"kind", "while"}, {"pre_cond", pre_cond},
-            {"until", until}, {"cond", cond->ToJson()},
+            {"until", until}, {"cond", cond->ToJson(compiler)},
             {"body", std::move(body_args)}
         };
     }
 
-    value DimStmt::ToJson() const {
+    value DimStmt::ToJson(const lexer::Compiler &compiler) const {
         return {
-            {"kind", "dim"}, {"var", var->ToJson()}
+            {"kind", "dim"}, {"var", var->ToJson(compiler)}
         };
     }
 
-    value ForStmt::ToJson() const {
+    value ForStmt::ToJson(const lexer::Compiler &compiler) const {
         array body_args;
         for (auto& st: body) {
-            body_args.emplace_back(st->ToJson());
+            body_args.emplace_back(st->ToJson(compiler));
         }
         return {
-            {"kind", "for"}, {"var", var}, {"from", from->ToJson()},
-            {"to", to->ToJson()}, {"body", std::move(body_args)}
+            {"kind", "for"}, {"var", compiler.GetName(var)}, {"from", from->ToJson(compiler)},
+            {"to", to->ToJson(compiler)}, {"body", std::move(body_args)}
         };
     }
 
-    value Function::ToJson() const {
+    value Function::ToJson(const lexer::Compiler &compiler) const {
         array params_args;
         for (auto& p: params) {
-            params_args.emplace_back(p->ToJson());
+            params_args.emplace_back(p->ToJson(compiler));
         }
         array body_args;
         for (auto& s: body) {
-            body_args.emplace_back(s->ToJson());
+            body_args.emplace_back(s->ToJson(compiler));
         }
         return {
-            {"kind", is_sub ? "sub" : "function"}, {"name", name},
+            {"kind", is_sub ? "sub" : "function"}, {"name", compiler.GetName(name)},
             {"ret_mark", return_type_mark}, {"params", std::move(params_args)},
             {"body", std::move(body_args)}
         };
     }
 
-    value Program::ToJson() const {
+    value Program::ToJson(const lexer::Compiler &compiler) const {
         array funcs_args;
         for (auto& f: funcs) {
-            funcs_args.emplace_back(f->ToJson());
+            funcs_args.emplace_back(f->ToJson(compiler));
         }
         array body_args;
         for (auto& st: main_body) {
-            body_args.emplace_back(st->ToJson());
+            body_args.emplace_back(st->ToJson(compiler));
         }
         return {
             {"functions", std::move(funcs_args)}, {"statements", std::move(body_args)}
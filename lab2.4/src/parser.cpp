@@ -4,49 +4,70 @@
 namespace parser {
     using lexer::DomainTag;
 
-    template <typename T>
-    std::unique_ptr<T> Parser::ExpectAndCast(const DomainTag tag) {
-        if (sym->GetTag() != tag) {
-            ThrowParseError({tag});
+    void Parser::Advance() {
+        if (index + 1 < tokens.Size()) {
+            sym = &tokens[++index];
+        } else if (pipeline && sym->tag != DomainTag::EndOfProgram) {
+            tokens = pipeline->Next();
+            index = 0;
+            sym = &tokens[index];
         }
-        auto ptr = SymTo<T>();
-        sym = scanner->NextToken();
-        return ptr;
     }
 
-    void Parser::Expect(const DomainTag tag) {
-        if (sym->GetTag() != tag) {
+    lexer::TokenRecord Parser::ExpectAndTake(const DomainTag tag) {
+        if (sym->tag != tag) {
             ThrowParseError({tag});
         }
-        sym = scanner->NextToken();
+        lexer::TokenRecord tok = *sym;
+        Advance();
+        return tok;
     }
 
-    template <typename T>
-    std::unique_ptr<T> Parser::SymTo() {
-        return std::unique_ptr<T>{static_cast<T*>(sym.release())};
+    void Parser::Expect(const DomainTag tag) {
+        if (sym->tag != tag) {
+            ThrowParseError({tag});
+        }
+        Advance();
     }
 
     void Parser::ThrowParseError(std::vector<DomainTag>&& exp) {
         std::ostringstream oss;
-        oss << sym->GetCoords() << ": expected ";
+        oss << scanner->Lines().Format(tokens.Coords(*sym)) << ": expected ";
         for (auto t : exp) {
             oss << t << " ";
         }
-        oss << "but got " << sym->GetTag();
+        oss << "but got " << sym->tag;
         throw std::runtime_error(oss.str());
     }
 
     std::unique_ptr<Program> Parser::RecursiveDescentParse() {
-        sym = scanner->NextToken();
-        auto prog = Program();
-        Expect(DomainTag::EndOfProgram);
-        return prog;
+        if (options.pipelined) {
+            pipeline = std::make_unique<lexer::TokenPipeline>(scanner.get());
+        }
+        try {
+            if (pipeline) {
+                tokens = pipeline->Next();
+            } else if (options.pool) {
+                tokens = scanner->Tokenize(*options.pool);
+            } else {
+                tokens = scanner->Tokenize();
+            }
+            index = 0;
+            sym = &tokens[index];
+            auto prog = Program();
+            Expect(DomainTag::EndOfProgram);
+            pipeline.reset();
+            return prog;
+        } catch (...) {
+            pipeline.reset();
+            throw;
+        }
     }
 
     // Program ::= Function* Statements
     std::unique_ptr<Program> Parser::Program() {
         std::vector<std::unique_ptr<parser::Function>> funs;
-        while (sym->GetTag() == DomainTag::KFunction || sym->GetTag() == DomainTag::KSub) {
+        while (sym->tag == DomainTag::KFunction || sym->tag == DomainTag::KSub) {
             funs.push_back(Function());
         }
         auto sts = Statements();
@@ -57,25 +78,25 @@ namespace parser {
     //          |  'Sub' IDENT '(' Params? ')' Statements 'End' 'Sub'
     std::unique_ptr<parser::Function> Parser::Function() {
         bool is_sub = false;
-        std::string func_name;
+        Symbol func_name = 0;
         std::string type_mark;
 
-        if (sym->GetTag() == lexer::DomainTag::KFunction) {
+        if (sym->tag == lexer::DomainTag::KFunction) {
             Expect(lexer::DomainTag::KFunction);
             auto var_def = VarDef();
             func_name = var_def->name;
             type_mark  = var_def->type;
-        } else if (sym->GetTag() == lexer::DomainTag::KSub) {
+        } else if (sym->tag == lexer::DomainTag::KSub) {
             Expect(lexer::DomainTag::KSub);
             is_sub = true;
-            auto ident_tok = ExpectAndCast<lexer::IdentToken>(lexer::DomainTag::Ident);
-            func_name = ident_tok->GetVal();
+            auto ident_tok = ExpectAndTake(lexer::DomainTag::Ident);
+            func_name = tokens.Name(ident_tok);
             type_mark  = "";
         }
 
         Expect(lexer::DomainTag::LeftParen);
         std::vector<std::unique_ptr<parser::Expr>> params;
-        if (sym->GetTag() == lexer::DomainTag::Plus || sym->GetTag() == lexer::DomainTag::Minus || sym->GetTag() == lexer::DomainTag::Ident) {
+        if (sym->tag == lexer::DomainTag::Plus || sym->tag == lexer::DomainTag::Minus || sym->tag == lexer::DomainTag::Ident) {
             params = Params();
         }
         Expect(lexer::DomainTag::RightParen);
@@ -87,7 +108,7 @@ namespace parser {
 
         return std::make_unique<parser::Function>(
                 is_sub,
-                std::move(func_name),
+                func_name,
                 std::move(type_mark),
                 std::move(params),
                 std::move(body)
@@ -98,8 +119,8 @@ namespace parser {
     std::vector<std::unique_ptr<Expr>> Parser::Params() {
         std::vector<std::unique_ptr<parser::Expr>> params;
         params.push_back(Expr());
-        while (sym->GetTag() == DomainTag::Comma) {
-            sym = scanner->NextToken();
+        while (sym->tag == DomainTag::Comma) {
+            Advance();
             params.push_back(Expr());
         }
         return params;
@@ -107,16 +128,16 @@ namespace parser {
 
     //VarDef ::= IDENT Type
     std::unique_ptr<Var> Parser::VarDef() {
-        auto ident = ExpectAndCast<lexer::IdentToken>(DomainTag::Ident);
-        auto type = ExpectAndCast<lexer::SpecToken>(DomainTag::Type);
-        return std::make_unique<Var>(ident->GetVal(), type->GetVal());
+        auto ident = ExpectAndTake(DomainTag::Ident);
+        auto type = ExpectAndTake(DomainTag::Type);
+        return std::make_unique<Var>(tokens.Name(ident), std::string(tokens.Text(type)));
     }
 
     // Statements ::= Statement*
     std::vector<std::unique_ptr<Stmt>> Parser::Statements() {
         std::vector<std::unique_ptr<Stmt>> stms;
         while (true) {
-            switch (sym->GetTag()) {
+            switch (sym->tag) {
                 case DomainTag::Ident:
                 case DomainTag::KIf:
                 case DomainTag::KDo:
@@ -132,7 +153,7 @@ namespace parser {
 
     // Statement ::= AssignStmt | IfStmt | WhileStmt | ForStmt | DimStmt
     std::unique_ptr<Stmt> Parser::Statement() {
-        switch (sym->GetTag()) {
+        switch (sym->tag) {
             case DomainTag::Ident: {
                 return AssignStmt();
             }
@@ -172,8 +193,8 @@ namespace parser {
         Expect(DomainTag::KThen);
         auto then_part = Statements();
         std::vector<std::unique_ptr<Stmt>> else_part;
-        if (sym->GetTag() == DomainTag::KElse) {
-            sym = scanner->NextToken();
+        if (sym->tag == DomainTag::KElse) {
+            Advance();
             else_part = Statements();
         }
         Expect(DomainTag::KEnd);
@@ -194,9 +215,9 @@ namespace parser {
     std::unique_ptr<WhileStmt> Parser::WhileStmt() {
         Expect(DomainTag::KDo);
 
-        if (sym->GetTag() == DomainTag::KWhile || sym->GetTag() == DomainTag::KUntil) {
-            bool is_until = (sym->GetTag() == DomainTag::KUntil);
-            sym = scanner->NextToken();
+        if (sym->tag == DomainTag::KWhile || sym->tag == DomainTag::KUntil) {
+            bool is_until = (sym->tag == DomainTag::KUntil);
+            Advance();
             auto cond = Expr();
             auto body = Statements();
             Expect(DomainTag::KLoop);
@@ -209,9 +230,9 @@ namespace parser {
         auto body = Statements();
         Expect(DomainTag::KLoop);
 
-        if (sym->GetTag() == DomainTag::KWhile || sym->GetTag() == DomainTag::KUntil) {
-            bool is_until = (sym->GetTag() == DomainTag::KUntil);
-            sym = scanner->NextToken();
+        if (sym->tag == DomainTag::KWhile || sym->tag == DomainTag::KUntil) {
+            bool is_until = (sym->tag == DomainTag::KUntil);
+            Advance();
             auto cond = Expr();
             return std::make_unique<parser::WhileStmt>(
                     true, is_until,
@@ -237,7 +258,7 @@ namespace parser {
         Expect(DomainTag::KNext);
         auto ctrl = VarDef();
         return std::make_unique<parser::ForStmt>(
-                std::move(var->name), std::move(from),
+                var->name, std::move(from),
                 std::move(to), std::move(body)
         );
     }
@@ -252,12 +273,12 @@ namespace parser {
     // Expr ::= ArithmExpr ( RelOp ArithmExpr )?
     std::unique_ptr<Expr> Parser::Expr() {
         auto left = ArithmExpr();
-        if (sym->GetTag() == DomainTag::RelOp) {
-            auto op = ExpectAndCast<lexer::SpecToken>(DomainTag::RelOp);
+        if (sym->tag == DomainTag::RelOp) {
+            auto op = ExpectAndTake(DomainTag::RelOp);
             auto right  = ArithmExpr();
             return std::make_unique<parser::Binary>(
                     std::move(left),
-                    op->GetVal(),
+                    std::string(tokens.Text(op)),
                     std::move(right)
             );
         }
@@ -266,12 +287,12 @@ namespace parser {
 
     // ArithmExpr ::= ('+' | '-')? Term ( AddOp Term )*
     std::unique_ptr<Expr> Parser::ArithmExpr() {
-        bool has_sign = (sym->GetTag() == DomainTag::Plus || sym->GetTag() == DomainTag::Minus);
+        bool has_sign = (sym->tag == DomainTag::Plus || sym->tag == DomainTag::Minus);
         DomainTag sign;
 
         if (has_sign) {
-            auto s = ExpectAndCast<lexer::SpecToken>(sym->GetTag());
-            sign = s->GetTag();
+            auto s = ExpectAndTake(sym->tag);
+            sign = s.tag;
         }
 
         auto expr = Term();
@@ -279,10 +300,10 @@ namespace parser {
             expr = std::make_unique<Unary>(sign, std::move(expr));
         }
 
-        while (sym->GetTag() == DomainTag::Plus || sym->GetTag() == DomainTag::Minus) {
-            auto op = ExpectAndCast<lexer::SpecToken>(sym->GetTag());
+        while (sym->tag == DomainTag::Plus || sym->tag == DomainTag::Minus) {
+            auto op = ExpectAndTake(sym->tag);
             auto rhs = Term();
-            expr = std::make_unique<Binary>(std::move(expr), op->GetVal(), std::move(rhs));
+            expr = std::make_unique<Binary>(std::move(expr), std::string(tokens.Text(op)), std::move(rhs));
         }
         return expr;
     }
@@ -290,10 +311,10 @@ namespace parser {
     // Term ::= Factor ( MulOp Factor )*
     std::unique_ptr<Expr> Parser::Term() {
         auto expr = Factor();
-        while (sym->GetTag() == DomainTag::MulOp) {
-            auto op = ExpectAndCast<lexer::SpecToken>(DomainTag::MulOp);
+        while (sym->tag == DomainTag::MulOp) {
+            auto op = ExpectAndTake(DomainTag::MulOp);
             auto rhs = Factor();
-            expr = std::make_unique<Binary>(std::move(expr), op->GetVal(), std::move(rhs));
+            expr = std::make_unique<Binary>(std::move(expr), std::string(tokens.Text(op)), std::move(rhs));
         }
         return expr;
     }
@@ -303,33 +324,33 @@ namespace parser {
     //          | '(' Expr ')'
     std::unique_ptr<Expr> Parser::Factor()
     {
-        switch (sym->GetTag()) {
+        switch (sym->tag) {
             case DomainTag::Ident: {
-                auto ident_tok = ExpectAndCast<lexer::IdentToken>(DomainTag::Ident);
+                auto ident_tok = ExpectAndTake(DomainTag::Ident);
 
                 std::string type_mark;
-                if (sym->GetTag() == DomainTag::Type) {
-                    type_mark = ExpectAndCast<lexer::SpecToken>(DomainTag::Type)->GetVal();
+                if (sym->tag == DomainTag::Type) {
+                    type_mark = std::string(tokens.Text(ExpectAndTake(DomainTag::Type)));
                 }
 
-                auto node = std::make_unique<Var>(ident_tok->GetVal(), type_mark);
+                auto node = std::make_unique<Var>(tokens.Name(ident_tok), type_mark);
 
-                if (sym->GetTag() == DomainTag::LeftParen) {
+                if (sym->tag == DomainTag::LeftParen) {
                     Expect(DomainTag::LeftParen);
-                    auto params = (sym->GetTag() == DomainTag::RightParen)
+                    auto params = (sym->tag == DomainTag::RightParen)
                                   ? std::vector<ExprPtr>{}
                                   : Params();
                     Expect(DomainTag::RightParen);
                     return std::make_unique<parser::Call>(
-                               std::move(node->name),
+                               node->name,
                          std::move(params)
                     );
-                } else if (sym->GetTag() == DomainTag::LeftBracket) {
+                } else if (sym->tag == DomainTag::LeftBracket) {
                     Expect(DomainTag::LeftBracket);
                     auto idx = Expr();
                     Expect(DomainTag::RightBracket);
                     return std::make_unique<IndexedVar>(
-                            std::move(node->name),
+                            node->name,
                      std::move(idx)
                     );
                 }
@@ -341,7 +362,7 @@ namespace parser {
                 return Const();
             }
             case DomainTag::LeftParen: {
-                sym = scanner->NextToken();
+                Advance();
                 auto e = Expr();
                 Expect(DomainTag::RightParen);
                 return e;
@@ -358,18 +379,20 @@ namespace parser {
 
     // Const ::= INT_CONST | REAL_CONST | STRING_CONST
     std::unique_ptr<Expr> Parser::Const() {
-        switch (sym->GetTag()) {
+        switch (sym->tag) {
             case DomainTag::IntConst: {
-                auto tok = ExpectAndCast<lexer::IntConstToken>(DomainTag::IntConst);
-                return std::make_unique<ConstInt>(tok->GetVal());
+                int val = tokens.Int(*sym);
+                Expect(DomainTag::IntConst);
+                return std::make_unique<ConstInt>(val);
             }
             case DomainTag::RealConst: {
-                auto tok = ExpectAndCast<lexer::RealConstToken>(DomainTag::RealConst);
-                return std::make_unique<ConstReal>(tok->GetVal());
+                double val = tokens.Real(*sym);
+                Expect(DomainTag::RealConst);
+                return std::make_unique<ConstReal>(val);
             }
             case DomainTag::StringConst: {
-                auto tok = ExpectAndCast<lexer::StringConstToken>(DomainTag::StringConst);
-                return std::make_unique<ConstString>(tok->GetVal());
+                auto tok = ExpectAndTake(DomainTag::StringConst);
+                return std::make_unique<ConstString>(std::string(tokens.Text(tok)));
             }
             default: {
                 ThrowParseError({
@@ -1,111 +1,267 @@
 #include "include/scanner.h"
+#include "include/dfa.h"
+#include "include/skip.h"
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
 #include <string>
-#include <regex>
 
 namespace lexer {
 
     struct RegexDomain {
         DomainTag tag;
-        std::regex pattern;
+        DfaRule rule;
 
-        RegexDomain(DomainTag tag, const std::regex &pattern)
-        : tag(tag), pattern(pattern) {}
+        RegexDomain(DomainTag tag, const std::string &pattern, bool icase = false)
+        : tag(tag), rule(pattern, icase) {}
     };
 
+    // Identifiers ([A-Za-z][A-Za-z0-9]*) are matched by SkipIdent and
+    // classified by the keyword table below.
     std::vector<RegexDomain> regexes = {
-            RegexDomain(DomainTag::Ident, std::regex(R"([A-Za-z][A-Za-z0-9]*)")),
-            RegexDomain(DomainTag::LeftParen, std::regex(R"(\()")),
-            RegexDomain(DomainTag::RightParen, std::regex(R"(\))")),
-            RegexDomain(DomainTag::LeftBracket, std::regex(R"(\[)")),
-            RegexDomain(DomainTag::RightBracket, std::regex(R"(\])")),
-            RegexDomain(DomainTag::Comma, std::regex(R"(,)")),
-            RegexDomain(DomainTag::Assign, std::regex(R"(=)")),
-            RegexDomain(DomainTag::Type, std::regex(R"([%&!#$])")),
-            RegexDomain(DomainTag::Plus, std::regex(R"(\+)")),
-            RegexDomain(DomainTag::Minus, std::regex(R"(-)")),
-            RegexDomain(DomainTag::MulOp, std::regex(R"([\*/])")),
-            RegexDomain(DomainTag::RelOp, std::regex(R"(>=|<=|==|<>|>|<)")),
-            RegexDomain(DomainTag::KFunction, std::regex(R"(function)", std::regex::icase)),
-            RegexDomain(DomainTag::KEnd, std::regex(R"(end)", std::regex::icase)),
-            RegexDomain(DomainTag::KSub, std::regex(R"(sub)", std::regex::icase)),
-            RegexDomain(DomainTag::KIf, std::regex(R"(if)", std::regex::icase)),
-            RegexDomain(DomainTag::KThen, std::regex(R"(then)", std::regex::icase)),
-            RegexDomain(DomainTag::KElse, std::regex(R"(else)", std::regex::icase)),
-            RegexDomain(DomainTag::KDo, std::regex(R"(do)", std::regex::icase)),
-            RegexDomain(DomainTag::KWhile, std::regex(R"(while)", std::regex::icase)),
-            RegexDomain(DomainTag::KLoop, std::regex(R"(loop)", std::regex::icase)),
-            RegexDomain(DomainTag::KUntil, std::regex(R"(until)", std::regex::icase)),
-            RegexDomain(DomainTag::KFor, std::regex(R"(for)", std::regex::icase)),
-            RegexDomain(DomainTag::KDim, std::regex(R"(dim)", std::regex::icase)),
-            RegexDomain(DomainTag::KTo, std::regex(R"(to)", std::regex::icase)),
-            RegexDomain(DomainTag::KNext, std::regex(R"(next)", std::regex::icase)),
-            RegexDomain(DomainTag::IntConst, std::regex(R"([0-9]+)")),
-            RegexDomain(DomainTag::RealConst, std::regex(R"([0-9]+\.[0-9]+)")),
-            RegexDomain(DomainTag::StringConst, std::regex("\"([^\"\\n]*)\"")),
+            RegexDomain(DomainTag::LeftParen, R"(\()"),
+            RegexDomain(DomainTag::RightParen, R"(\))"),
+            RegexDomain(DomainTag::LeftBracket, R"(\[)"),
+            RegexDomain(DomainTag::RightBracket, R"(\])"),
+            RegexDomain(DomainTag::Comma, R"(,)"),
+            RegexDomain(DomainTag::Assign, R"(=)"),
+            RegexDomain(DomainTag::Type, R"([%&!#$])"),
+            RegexDomain(DomainTag::Plus, R"(\+)"),
+            RegexDomain(DomainTag::Minus, R"(-)"),
+            RegexDomain(DomainTag::MulOp, R"([\*/])"),
+            RegexDomain(DomainTag::RelOp, R"(>=|<=|==|<>|>|<)"),
+            RegexDomain(DomainTag::IntConst, R"([0-9]+)"),
+            RegexDomain(DomainTag::RealConst, R"([0-9]+\.[0-9]+)"),
+            RegexDomain(DomainTag::StringConst, "\"([^\"\\n]*)\""),
     };
 
-    std::regex WhiteSpaceRegex = std::regex(R"([ \t\n\r]+)");
-    std::regex CommentRegex = std::regex(R"('[^\n]*)");
+    Dfa BuildDfa() {
+        std::vector<DfaRule> rules;
+        for (auto &rd: regexes) {
+            rules.push_back(rd.rule);
+        }
+        return Dfa(rules);
+    }
 
+    const Dfa dfa = BuildDfa();
 
-    std::unique_ptr <Token> Scanner::NextToken() {
-        DomainTag keywords[] = {
-                DomainTag::KFunction, DomainTag::KEnd, DomainTag::KSub,
-                DomainTag::KIf, DomainTag::KThen, DomainTag::KElse,
-                DomainTag::KDo, DomainTag::KWhile, DomainTag::KLoop,
-                DomainTag::KUntil, DomainTag::KFor, DomainTag::KDim,
-               DomainTag::KTo, DomainTag::KNext
-        };
-
-        std::smatch m;
-        auto program_rest = program.substr(cur.GetIndex());
-
-        size_t lex_len = 0;
-        DomainTag lex_tag;
-
-        while (lex_len == 0) {
-            if (cur.EndOfProgram()) {
-                return std::make_unique<EOFToken>(cur, cur);
-            }
-            if (std::regex_search(program_rest, m, WhiteSpaceRegex, std::regex_constants::match_continuous)) {
-                size_t len = m.str(0).size();
-                cur += len;
-            } else if (std::regex_search(program_rest, m, CommentRegex, std::regex_constants::match_continuous)) {
-                size_t len = m.str(0).size();
-                Position start = cur;
-                start += 1;
+    struct Keyword {
+        std::string_view word;
+        DomainTag tag;
+    };
+
+    constexpr Keyword keywords[] = {
+            {"function", DomainTag::KFunction},
+            {"end", DomainTag::KEnd},
+            {"sub", DomainTag::KSub},
+            {"if", DomainTag::KIf},
+            {"then", DomainTag::KThen},
+            {"else", DomainTag::KElse},
+            {"do", DomainTag::KDo},
+            {"while", DomainTag::KWhile},
+            {"loop", DomainTag::KLoop},
+            {"until", DomainTag::KUntil},
+            {"for", DomainTag::KFor},
+            {"dim", DomainTag::KDim},
+            {"to", DomainTag::KTo},
+            {"next", DomainTag::KNext},
+    };
+
+    const size_t KeywordTableSize = 32;
+    const size_t MaxKeywordLength = 8;
+
+    // Perfect for the lowercased keywords above (checked below). c | 0x20
+    // lowercases letters and leaves digits unchanged.
+    constexpr size_t KeywordHash(const char *s, size_t len) {
+        return ((s[0] | 0x20) + 27 * (s[len - 1] | 0x20) + len) & (KeywordTableSize - 1);
+    }
+
+    constexpr std::array<Keyword, KeywordTableSize> BuildKeywordTable() {
+        std::array<Keyword, KeywordTableSize> table{};
+        for (auto &kw: keywords) {
+            table[KeywordHash(kw.word.data(), kw.word.size())] = kw;
+        }
+        return table;
+    }
+
+    constexpr std::array<Keyword, KeywordTableSize> keywordTable = BuildKeywordTable();
+
+    constexpr bool KeywordHashIsPerfect() {
+        for (auto &kw: keywords) {
+            if (keywordTable[KeywordHash(kw.word.data(), kw.word.size())].word != kw.word) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(KeywordHashIsPerfect(), "keyword hash has collisions");
+
+    DomainTag ClassifyIdent(const char *lex, size_t len) {
+        if (len < 2 || len > MaxKeywordLength) {
+            return DomainTag::Ident;
+        }
+        const Keyword &kw = keywordTable[KeywordHash(lex, len)];
+        if (kw.word.size() != len) {
+            return DomainTag::Ident;
+        }
+        for (size_t i = 0; i < len; i++) {
+            if ((lex[i] | 0x20) != kw.word[i]) {
+                return DomainTag::Ident;
+            }
+        }
+        return kw.tag;
+    }
+
+
+    // Same results as std::stoi/std::stoll on the lexeme, without copying it.
+    template <typename T>
+    T ParseInteger(std::string_view lex, const char *what) {
+        T val = 0;
+        auto res = std::from_chars(lex.data(), lex.data() + lex.size(), val);
+        if (res.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range(what);
+        }
+        return val;
+    }
+
+    DomainTag Scanner::NextLexeme(Position &start) {
+        const char *text = program.data();
+        const char *text_end = text + limit;
+
+        while (true) {
+            if (cur.GetIndex() == limit) {
+                start = cur;
+                return DomainTag::EndOfProgram;
+            }
+            // Whitespace, comments and identifier runs are found by the
+            // vectorized skip routines; everything else goes through the DFA.
+            size_t index = cur.GetIndex();
+            auto c = static_cast<unsigned char>(text[index]);
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                cur = Position(SkipWhiteSpace(text, index + 1, limit));
+                continue;
+            } else if (c == '\'') {
+                Position comment_start(index + 1);
+                cur = Position(SkipLine(text, index + 1, limit));
+                comments.emplace_back(comment_start, cur);
+                continue;
+            }
+
+            if (std::isalpha(c)) {
+                size_t end = SkipIdent(text, index + 1, limit);
+                start = cur;
+                cur = Position(end);
+                return ClassifyIdent(text + index, end - index);
+            }
+
+            int rule;
+            size_t len = dfa.Match(text + index, text_end, rule);
+            if (rule >= 0) {
+                start = cur;
                 cur += len;
-                comments.emplace_back(start, cur);
+                return regexes[rule].tag;
             } else {
-                for (auto &rd: regexes) {
-                    if (std::regex_search(program_rest, m, rd.pattern, std::regex_constants::match_continuous)) {
-                        size_t len = m.str(0).size();
-                        if (len > lex_len) {
-                            lex_len = len;
-                            lex_tag = rd.tag;
-                        } else if (len == lex_len && lex_tag == DomainTag::Ident) {
-                            for (auto keyword : keywords) {
-                                if (rd.tag == keyword) {
-                                    lex_tag = rd.tag;
-                                }
-                            }
-                        }
-                    }
-                }
-                if (lex_len == 0) {
-                    compiler->AddMessage(cur, MessageType::Error, "unexpected char");
-                    cur++;
+                compiler->AddMessage(cur, MessageType::Error, "unexpected char");
+                cur++;
+            }
+        }
+    }
+
+    TokenStream Scanner::Tokenize() {
+        TokenStream tokens(program);
+        TokenizeBatch(tokens, SIZE_MAX);
+        return tokens;
+    }
+
+    bool Scanner::TokenizeBatch(TokenStream &tokens, size_t max_tokens) {
+        Position start = cur;
+        for (size_t i = 0; i < max_tokens; i++) {
+            DomainTag tag = NextLexeme(start);
+            std::string_view lex(program.data() + start.GetIndex(), cur.GetIndex() - start.GetIndex());
+            uint32_t payload = 0;
+            if (tag == DomainTag::Ident) {
+                payload = compiler->AddName(lex);
+            } else if (tag == DomainTag::IntConst) {
+                payload = tokens.AddInt(ParseInteger<int>(lex, "stoi"));
+            } else if (tag == DomainTag::RealConst) {
+                payload = tokens.AddReal(ParseInteger<long long>(lex, "stoll"));
+            }
+            tokens.Push(tag, start.GetIndex(), cur.GetIndex(), payload);
+            if (tag == DomainTag::EndOfProgram) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Comments and string constants cannot cross a newline, so chunks cut
+    // right after a '\n' are tokenized independently and concatenated.
+    TokenStream Scanner::Tokenize(util::ThreadPool &pool, size_t chunk_size) {
+        std::vector<uint64_t> bounds = {cur.GetIndex()};
+        while (limit - bounds.back() > chunk_size) {
+            uint64_t end = SkipLine(program.data(), bounds.back() + chunk_size, limit);
+            if (end == limit) {
+                break;
+            }
+            bounds.push_back(end + 1);
+        }
+        if (bounds.size() == 1) {
+            return Tokenize();
+        }
+        bounds.push_back(limit);
+
+        size_t count = bounds.size() - 1;
+        std::vector<Compiler> compilers(count);
+        std::vector<std::vector<Fragment>> chunk_comments(count);
+        std::vector<std::future<TokenStream>> chunks;
+        for (size_t i = 0; i < count; i++) {
+            chunks.push_back(pool.Submit([this, &bounds, &compilers, &chunk_comments, i] {
+                Scanner chunk(program, &compilers[i]);
+                chunk.cur = Position(bounds[i]);
+                chunk.limit = bounds[i + 1];
+                auto tokens = chunk.Tokenize();
+                chunk_comments[i] = std::move(chunk.comments);
+                return tokens;
+            }));
+        }
+
+        std::vector<TokenStream> streams;
+        std::exception_ptr error;
+        for (auto &chunk: chunks) {
+            try {
+                streams.push_back(chunk.get());
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
                 }
             }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
 
-            program_rest = program.substr(cur.GetIndex());
+        TokenStream tokens(program);
+        for (size_t i = 0; i < count; i++) {
+            std::vector<uint32_t> codes(compilers[i].NameCount());
+            for (uint32_t code = 0; code < codes.size(); code++) {
+                codes[code] = compiler->AddName(compilers[i].GetName(code));
+            }
+            tokens.Append(streams[i], codes);
+            compiler->MergeMessages(compilers[i]);
+            comments.insert(comments.end(), chunk_comments[i].begin(), chunk_comments[i].end());
         }
+        cur = Position(limit);
+        tokens.Push(DomainTag::EndOfProgram, limit, limit, 0);
+        return tokens;
+    }
 
-        Position start(&program), end(&program);
-        start = cur;
-        cur += lex_len;
-        end = cur;
-        std::string lex = program.substr(start.GetIndex(), end.GetIndex() - start.GetIndex());
+    std::unique_ptr <Token> Scanner::NextToken() {
+        Position start = cur;
+        DomainTag lex_tag = NextLexeme(start);
+        Position end = cur;
+        std::string_view lex(program.data() + start.GetIndex(), end.GetIndex() - start.GetIndex());
 
         switch (lex_tag) {
             case DomainTag::Ident: {
@@ -137,14 +293,14 @@ namespace lexer {
             }
             case DomainTag::IntConst: {
                 return std::make_unique<IntConstToken>(
-                        std::stoi(lex),
+                        ParseInteger<int>(lex, "stoi"),
                         start,
                         end
                 );
             }
             case DomainTag::RealConst: {
                 return std::make_unique<RealConstToken>(
-                        std::stoll(lex),
+                        ParseInteger<long long>(lex, "stoll"),
                         start,
                         end
                 );
@@ -156,6 +312,9 @@ namespace lexer {
                         end
                 );
             }
+            case DomainTag::EndOfProgram: {
+                return std::make_unique<EOFToken>(start, end);
+            }
             default: {
                 return std::make_unique<SpecToken>(
                         lex_tag,
@@ -0,0 +1,161 @@
+#include "include/skip.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SKIP_X86
+#endif
+
+namespace lexer {
+
+    namespace {
+
+        inline bool IsWhiteSpace(unsigned char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        inline bool IsNotNewLine(unsigned char c) {
+            return c != '\n';
+        }
+
+        inline bool IsIdentChar(unsigned char c) {
+            return static_cast<unsigned char>((c | 0x20) - 'a') < 26 || static_cast<unsigned char>(c - '0') < 10;
+        }
+
+        template <bool (*InRun)(unsigned char)>
+        size_t RunScalar(const char *text, size_t i, size_t size) {
+            while (i < size && InRun(static_cast<unsigned char>(text[i]))) {
+                i++;
+            }
+            return i;
+        }
+
+#ifdef SKIP_X86
+        inline __m128i InRange(__m128i v, char lo, char count) {
+            __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+            return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(static_cast<char>(count - 1))), t);
+        }
+
+        inline unsigned WhiteSpaceMask(__m128i v) {
+            __m128i m = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            return ~_mm_movemask_epi8(m) & 0xFFFFu;
+        }
+
+        inline unsigned NewLineMask(__m128i v) {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        }
+
+        inline unsigned IdentMask(__m128i v) {
+            __m128i letter = InRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26);
+            __m128i digit = InRange(v, '0', 10);
+            return ~_mm_movemask_epi8(_mm_or_si128(letter, digit)) & 0xFFFFu;
+        }
+
+        // StopMask returns a bit per byte that does not belong to the run.
+        template <unsigned (*StopMask)(__m128i), bool (*InRun)(unsigned char)>
+        size_t RunSse2(const char *text, size_t i, size_t size) {
+            for (; i + 16 <= size; i += 16) {
+                unsigned stop = StopMask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i)));
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+            return RunScalar<InRun>(text, i, size);
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i InRange256(__m256i v, char lo, char count) {
+            __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(static_cast<char>(count - 1))), t);
+        }
+
+        __attribute__((target("avx2")))
+        inline unsigned WhiteSpaceMask256(__m256i v) {
+            __m256i m = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+            return ~static_cast<unsigned>(_mm256_movemask_epi8(m));
+        }
+
+        __attribute__((target("avx2")))
+        inline unsigned NewLineMask256(__m256i v) {
+            return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        }
+
+        __attribute__((target("avx2")))
+        inline unsigned IdentMask256(__m256i v) {
+            __m256i letter = InRange256(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 26);
+            __m256i digit = InRange256(v, '0', 10);
+            return ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(letter, digit)));
+        }
+
+        template <unsigned (*StopMask)(__m256i), bool (*InRun)(unsigned char)>
+        __attribute__((target("avx2")))
+        size_t RunAvx2(const char *text, size_t i, size_t size) {
+            for (; i + 32 <= size; i += 32) {
+                unsigned stop = StopMask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i)));
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+            return RunScalar<InRun>(text, i, size);
+        }
+#endif
+
+        using SkipFn = size_t (*)(const char *, size_t, size_t);
+
+        struct SkipRoutines {
+            const char *name;
+            SkipFn white_space;
+            SkipFn line;
+            SkipFn ident;
+        };
+
+        SkipRoutines Select() {
+#ifdef SKIP_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return {
+                        "avx2",
+                        RunAvx2<WhiteSpaceMask256, IsWhiteSpace>,
+                        RunAvx2<NewLineMask256, IsNotNewLine>,
+                        RunAvx2<IdentMask256, IsIdentChar>
+                };
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return {
+                        "sse2",
+                        RunSse2<WhiteSpaceMask, IsWhiteSpace>,
+                        RunSse2<NewLineMask, IsNotNewLine>,
+                        RunSse2<IdentMask, IsIdentChar>
+                };
+            }
+#endif
+            return {
+                    "scalar",
+                    RunScalar<IsWhiteSpace>,
+                    RunScalar<IsNotNewLine>,
+                    RunScalar<IsIdentChar>
+            };
+        }
+
+        const SkipRoutines routines = Select();
+    }
+
+    size_t SkipWhiteSpace(const char *text, size_t from, size_t size) {
+        return routines.white_space(text, from, size);
+    }
+
+    size_t SkipLine(const char *text, size_t from, size_t size) {
+        return routines.line(text, from, size);
+    }
+
+    size_t SkipIdent(const char *text, size_t from, size_t size) {
+        return routines.ident(text, from, size);
+    }
+
+    const char *SkipImplementation() {
+        return routines.name;
+    }
+}
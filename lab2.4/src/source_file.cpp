@@ -0,0 +1,44 @@
+#include "include/source_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lexer {
+
+    SourceFile::SourceFile(const std::string &path)
+    : data(nullptr), size(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            close(fd);
+            throw std::runtime_error("cannot stat " + path + ": " + std::strerror(err));
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                int err = errno;
+                close(fd);
+                throw std::runtime_error("cannot map " + path + ": " + std::strerror(err));
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(mapping);
+        }
+        close(fd);
+    }
+
+    SourceFile::~SourceFile() {
+        if (data != nullptr) {
+            munmap(const_cast<char *>(data), size);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#include "include/token_pipeline.h"
+
+namespace lexer {
+
+    TokenPipeline::TokenPipeline(Scanner *scanner, size_t batch_size)
+    : scanner(scanner), batch_size(batch_size) {
+        producer = std::thread([this] { Produce(); });
+    }
+
+    TokenPipeline::~TokenPipeline() {
+        cancelled.store(true, std::memory_order_relaxed);
+        producer.join();
+    }
+
+    void TokenPipeline::Produce() {
+        bool done = false;
+        while (!done && !cancelled.load(std::memory_order_relaxed)) {
+            auto batch = std::make_unique<Batch>(scanner->Text());
+            try {
+                done = scanner->TokenizeBatch(batch->tokens, batch_size);
+            } catch (...) {
+                batch->error = std::current_exception();
+                done = true;
+            }
+            while (!ring.TryPush(std::move(batch))) {
+                if (cancelled.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    TokenStream TokenPipeline::Next() {
+        if (pending) {
+            std::rethrow_exception(pending);
+        }
+        std::unique_ptr<Batch> batch;
+        while (!ring.TryPop(batch)) {
+            std::this_thread::yield();
+        }
+        if (batch->error) {
+            if (batch->tokens.Size() == 0) {
+                std::rethrow_exception(batch->error);
+            }
+            pending = batch->error;
+        }
+        return std::move(batch->tokens);
+    }
+}